@@ -7,8 +7,11 @@
 #define BITFIELDS_HPP
 
 #include <array>
+#include <atomic>
 #include <climits>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <type_traits>
 
@@ -50,8 +53,103 @@ constexpr OutputIt transform(InputIt first1, InputIt last1, OutputIt d_first, Un
     return d_first;
 }
 
+//! Finalizer of the SplitMix64 generator: cheap, but spreads every input bit over the whole result.
+constexpr std::uint64_t mix(std::uint64_t v) noexcept
+{
+    v ^= v >> 30;
+    v *= 0xbf58476d1ce4e5b9;
+    v ^= v >> 27;
+    v *= 0x94d049bb133111eb;
+    v ^= v >> 31;
+    return v;
+}
+
+//! Field values storage, which can be modified through a const access, when Mutable is set.
+template<typename T, std::size_t N, bool Mutable>
+struct FieldValues
+{
+    constexpr T& operator[](std::size_t i) noexcept
+    {
+        return values[i];
+    }
+
+    constexpr const T& operator[](std::size_t i) const noexcept
+    {
+        return values[i];
+    }
+
+    std::array<T, N> values = {};
+};
+
+template<typename T, std::size_t N>
+struct FieldValues<T, N, true>
+{
+    constexpr T& operator[](std::size_t i) const noexcept
+    {
+        return values[i];
+    }
+
+    mutable std::array<T, N> values = {};
+};
+
 } // namespace detail
 
+namespace overflow
+{
+//! Masks the least significant bits of the value to fit into the field; the default policy.
+struct Wrap
+{
+    template<auto FieldId, typename T>
+    static constexpr T apply(T value, T mask) noexcept
+    {
+        return static_cast<T>(value & mask);
+    }
+};
+
+//! Sets the field to its maximum value, when the value doesn't fit into the field.
+struct Saturate
+{
+    template<auto FieldId, typename T>
+    static constexpr T apply(T value, T mask) noexcept
+    {
+        auto overflown{static_cast<T>((value & ~mask) != 0)};
+        return static_cast<T>((value & mask) | (mask * overflown));
+    }
+};
+
+//! Sets the field to zero, when the value doesn't fit into the field.
+struct Clear
+{
+    template<auto FieldId, typename T>
+    static constexpr T apply(T value, T mask) noexcept
+    {
+        auto fits{static_cast<T>((value & ~mask) == 0)};
+        return static_cast<T>((value & mask) * fits);
+    }
+};
+
+//! Applies the Policy; additionally, the bitfield group counts how many times each of its fields has been truncated.
+template<typename Policy = Wrap>
+struct Counting
+{
+    template<auto FieldId, typename T>
+    static constexpr T apply(T value, T mask) noexcept
+    {
+        return Policy::template apply<FieldId>(value, mask);
+    }
+};
+
+template<typename Policy>
+struct IsCounting : std::false_type
+{
+};
+
+template<typename Policy>
+struct IsCounting<Counting<Policy>> : std::true_type
+{
+};
+} // namespace overflow
+
 template<auto Id, unsigned Size>
 struct Field
 {
@@ -59,15 +157,15 @@ struct Field
     static inline constexpr auto size{Size};
 };
 
-template<typename UT, typename... Fields>
-class Bitfields
+template<typename OverflowPolicy, typename UT, typename... Fields>
+class BasicBitfields
 {
   public:
     using UnderlyingType = UT;
 
-    constexpr Bitfields() = default;
+    constexpr BasicBitfields() = default;
 
-    constexpr Bitfields(UnderlyingType preload)
+    constexpr BasicBitfields(UnderlyingType preload)
     {
         for (unsigned i{0}; i < NumberOfFields; ++i)
         {
@@ -83,7 +181,7 @@ class Bitfields
     {
         constexpr auto idx{find_field_index<FieldId>()};
         UnderlyingType& result{field_values[idx]};
-        result &= non_shifted_field_masks[idx];
+        result = to_field_value<FieldId>();
         return result;
     }
 
@@ -101,8 +199,7 @@ class Bitfields
     {
         constexpr auto idx{find_field_index<FieldId>()};
         constexpr auto shift{field_shifts[idx]};
-        constexpr auto mask{non_shifted_field_masks[idx]};
-        auto v{field_values[idx] & mask};
+        auto v{to_field_value<FieldId>()};
         auto result{static_cast<UnderlyingType>(v << shift)};
         return result;
     }
@@ -112,7 +209,125 @@ class Bitfields
         return (extract<Fields::id>() | ... | 0);
     }
 
+    //! Serializes only the specified fields; the bits of all the other fields are cleared.
+    template<auto FirstFieldId, auto... FieldIds>
+    constexpr UnderlyingType serialize() const noexcept
+    {
+        return (extract<FirstFieldId>() | ... | extract<FieldIds>());
+    }
+
+    //! Retrieves a single field from the serialized value, without loading (deserializing) the remaining fields.
+    template<auto FieldId>
+    static constexpr UnderlyingType deserialize(UnderlyingType serialized) noexcept
+    {
+        constexpr auto idx{find_field_index<FieldId>()};
+        constexpr auto shift{field_shifts[idx]};
+        constexpr auto mask{non_shifted_field_masks[idx]};
+        auto result{static_cast<UnderlyingType>((serialized >> shift) & mask)};
+        return result;
+    }
+
+    //! Mask of the specified fields within the serialized value, or of all the fields, when none is specified.
+    template<auto... FieldIds>
+    static constexpr UnderlyingType mask() noexcept
+    {
+        if constexpr (sizeof...(FieldIds) == 0)
+            return (field_masks[find_field_index<Fields::id>()] | ... | 0);
+        else
+            return (field_masks[find_field_index<FieldIds>()] | ... | 0);
+    }
+
+    //! Number of truncations of the field; requires the overflow::Counting policy.
+    template<auto FieldId>
+    static unsigned long truncations() noexcept
+    {
+        static_assert(overflow::IsCounting<OverflowPolicy>::value,
+                      "Truncations are counted by overflow::Counting only");
+        constexpr auto idx{find_field_index<FieldId>()};
+        return truncation_counters[idx].load(std::memory_order_relaxed);
+    }
+
+    template<auto FieldId>
+    static void reset_truncations() noexcept
+    {
+        static_assert(overflow::IsCounting<OverflowPolicy>::value,
+                      "Truncations are counted by overflow::Counting only");
+        constexpr auto idx{find_field_index<FieldId>()};
+        truncation_counters[idx].store(0, std::memory_order_relaxed);
+    }
+
+    //! Compares the fields one by one, so the bitfields are not serialized.
+    friend constexpr bool operator==(const BasicBitfields& lhs, const BasicBitfields& rhs) noexcept
+    {
+        auto lhs_values{lhs.to_field_values()}, rhs_values{rhs.to_field_values()};
+        for (unsigned i{0}; i < NumberOfFields; ++i)
+        {
+            if (lhs_values[i] != rhs_values[i])
+                return false;
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(const BasicBitfields& lhs, const BasicBitfields& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    //! Compares the fields lexicographically, what gives the same order as comparing the serialized values.
+    friend constexpr bool operator<(const BasicBitfields& lhs, const BasicBitfields& rhs) noexcept
+    {
+        auto lhs_values{lhs.to_field_values()}, rhs_values{rhs.to_field_values()};
+        for (unsigned i{0}; i < NumberOfFields; ++i)
+        {
+            if (lhs_values[i] != rhs_values[i])
+                return lhs_values[i] < rhs_values[i];
+        }
+        return false;
+    }
+
   private:
+    template<auto FieldId>
+    static inline constexpr UnderlyingType apply_overflow_policy(UnderlyingType value) noexcept
+    {
+        constexpr auto idx{find_field_index<FieldId>()};
+        constexpr auto mask{non_shifted_field_masks[idx]};
+        return static_cast<UnderlyingType>(OverflowPolicy::template apply<FieldId>(value, mask) & mask);
+    }
+
+    //! Field value with the overflow policy applied. When counting, the truncation is counted, and the truncated value
+    //! is stored, so that it is counted once only.
+    template<auto FieldId>
+    constexpr UnderlyingType to_field_value() const noexcept
+    {
+        constexpr auto idx{find_field_index<FieldId>()};
+        if constexpr (overflow::IsCounting<OverflowPolicy>::value)
+        {
+            UnderlyingType& value{field_values[idx]};
+            count_truncation<FieldId>(value);
+            value = apply_overflow_policy<FieldId>(value);
+            return value;
+        }
+        else
+        {
+            return apply_overflow_policy<FieldId>(field_values[idx]);
+        }
+    }
+
+    template<auto FieldId>
+    static constexpr void count_truncation(UnderlyingType value) noexcept
+    {
+        constexpr auto idx{find_field_index<FieldId>()};
+        constexpr auto mask{non_shifted_field_masks[idx]};
+        if ((value & ~mask) != 0)
+            truncation_counters[idx].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //! Field values with the overflow policy applied; the policy only masks them, by default.
+    constexpr auto to_field_values() const noexcept
+    {
+        return std::array<UnderlyingType, NumberOfFields>{to_field_value<Fields::id>()...};
+    }
+
     static inline constexpr auto to_field_shifts() noexcept
     {
         std::array<unsigned, NumberOfFields> shifts = {};
@@ -203,9 +418,87 @@ class Bitfields
     static_assert(calculate_occupied_bit_size() == UnderlyingTypeBitSize,
                   "Accumulated bit size is not equal to underlying type's bit size");
 
-    std::array<UnderlyingType, NumberOfFields> field_values = {};
+    //! Shared by all the instances of the bitfield group, instantiated only with the overflow::Counting policy.
+    static inline std::array<std::atomic<unsigned long>, NumberOfFields> truncation_counters = {};
+
+    detail::FieldValues<UnderlyingType, NumberOfFields, overflow::IsCounting<OverflowPolicy>::value> field_values = {};
+};
+
+template<typename UT, typename... Fields>
+using Bitfields = BasicBitfields<overflow::Wrap, UT, Fields...>;
+
+namespace detail
+{
+template<auto... FieldIds, typename OP, typename UT, typename... Fields>
+constexpr UT serialize_fields(const BasicBitfields<OP, UT, Fields...>& bf) noexcept
+{
+    if constexpr (sizeof...(FieldIds) == 0)
+        return bf.serialize();
+    else
+        return bf.template serialize<FieldIds...>();
+}
+} // namespace detail
+
+//! Hashes the bitfields by the specified fields only, or by all the fields, when none is specified.
+template<auto... FieldIds>
+struct BitfieldsHash
+{
+    template<typename OP, typename UT, typename... Fields>
+    constexpr std::size_t operator()(const BasicBitfields<OP, UT, Fields...>& bf) const noexcept
+    {
+        auto key{detail::serialize_fields<FieldIds...>(bf)};
+        return static_cast<std::size_t>(detail::mix(static_cast<std::uint64_t>(key)));
+    }
+};
+
+//! Compares the bitfields by the specified fields only, or by all the fields, when none is specified.
+template<auto... FieldIds>
+struct BitfieldsEqual
+{
+    template<typename OP, typename UT, typename... Fields>
+    constexpr bool operator()(const BasicBitfields<OP, UT, Fields...>& lhs,
+                              const BasicBitfields<OP, UT, Fields...>& rhs) const noexcept
+    {
+        if constexpr (sizeof...(FieldIds) == 0)
+            return lhs == rhs;
+        else
+            return detail::serialize_fields<FieldIds...>(lhs) == detail::serialize_fields<FieldIds...>(rhs);
+    }
+};
+
+//! Hashes the serialized Group by the specified fields only, or by all the fields, when none is specified.
+template<typename Group, auto... FieldIds>
+struct SerializedHash
+{
+    using UnderlyingType = typename Group::UnderlyingType;
+
+    constexpr std::size_t operator()(UnderlyingType serialized) const noexcept
+    {
+        auto key{static_cast<UnderlyingType>(serialized & Group::template mask<FieldIds...>())};
+        return static_cast<std::size_t>(detail::mix(static_cast<std::uint64_t>(key)));
+    }
+};
+
+//! Compares the serialized Group by the specified fields only, or by all the fields, when none is specified.
+template<typename Group, auto... FieldIds>
+struct SerializedEqual
+{
+    using UnderlyingType = typename Group::UnderlyingType;
+
+    constexpr bool operator()(UnderlyingType lhs, UnderlyingType rhs) const noexcept
+    {
+        return ((lhs ^ rhs) & Group::template mask<FieldIds...>()) == 0;
+    }
 };
 
 } // namespace jungles
 
+namespace std
+{
+template<typename OP, typename UT, typename... Fields>
+struct hash<jungles::BasicBitfields<OP, UT, Fields...>> : jungles::BitfieldsHash<>
+{
+};
+} // namespace std
+
 #endif /* BITFIELDS_HPP */
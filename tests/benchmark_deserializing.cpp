@@ -0,0 +1,69 @@
+/**
+ * @file        benchmark_deserializing.cpp
+ * @brief       Measures the cost of decoding a single field from a large buffer of packed records.
+ * @author      Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "jungles/bitfields.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+using Record = Bitfields<uint32_t,
+                         Field<Reg::field1, 2>,
+                         Field<Reg::field2, 1>,
+                         Field<Reg::field3, 1>,
+                         Field<Reg::field4, 4>,
+                         Field<Reg::field5, 1>,
+                         Field<Reg::field6, 7>,
+                         Field<Reg::field7, 16>>;
+
+using Histogram = std::array<std::size_t, 1 << 7>;
+
+TEST_CASE("Decoding a single field of packed records", "[!benchmark]")
+{
+    constexpr std::size_t number_of_records{1 << 22};
+
+    std::mt19937 generator{42};
+    std::vector<uint32_t> records(number_of_records);
+    for (auto& r : records)
+        r = static_cast<uint32_t>(generator());
+
+    Histogram expected = {};
+    for (auto r : records)
+        ++expected[(r >> 16) & 0x7F];
+
+    SECTION("Decoded histogram is correct")
+    {
+        Histogram by_construction = {}, by_deserialization = {};
+        for (auto r : records)
+        {
+            ++by_construction[Record{r}.at<Reg::field6>()];
+            ++by_deserialization[Record::deserialize<Reg::field6>(r)];
+        }
+        REQUIRE(by_construction == expected);
+        REQUIRE(by_deserialization == expected);
+    }
+
+    BENCHMARK("Histogram of a field, constructing each record")
+    {
+        Histogram histogram = {};
+        for (auto r : records)
+            ++histogram[Record{r}.at<Reg::field6>()];
+        return histogram;
+    };
+
+    BENCHMARK("Histogram of a field, deserializing the field only")
+    {
+        Histogram histogram = {};
+        for (auto r : records)
+            ++histogram[Record::deserialize<Reg::field6>(r)];
+        return histogram;
+    };
+}
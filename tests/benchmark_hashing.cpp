@@ -0,0 +1,194 @@
+/**
+ * @file        benchmark_hashing.cpp
+ * @brief       Measures the cost of probing hash tables keyed with bitfields.
+ * @author      Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "jungles/bitfields.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+using Key = Bitfields<uint32_t,
+                      Field<Reg::field1, 2>,
+                      Field<Reg::field2, 1>,
+                      Field<Reg::field3, 1>,
+                      Field<Reg::field4, 4>,
+                      Field<Reg::field5, 1>,
+                      Field<Reg::field6, 7>,
+                      Field<Reg::field7, 16>>;
+
+//! Minimal linear-probing table, with the capacity being a power of two.
+template<typename K, typename V, typename Hash, typename Equal>
+class OpenAddressingTable
+{
+  public:
+    explicit OpenAddressingTable(std::size_t capacity) : slots(capacity), mask{capacity - 1}
+    {
+    }
+
+    void insert(const K& key, V value)
+    {
+        auto& slot{slots[find_slot(key)]};
+        slot.emplace(key, value);
+    }
+
+    const V* find(const K& key) const
+    {
+        auto& slot{slots[find_slot(key)]};
+        return slot ? &slot->second : nullptr;
+    }
+
+  private:
+    using Slot = std::optional<std::pair<K, V>>;
+
+    std::size_t find_slot(const K& key) const
+    {
+        auto idx{Hash{}(key) & mask};
+        while (slots[idx] && !Equal{}(slots[idx]->first, key))
+            idx = (idx + 1) & mask;
+        return idx;
+    }
+
+    std::vector<Slot> slots;
+    std::size_t mask;
+};
+
+template<typename K, typename V, typename Hash, typename Equal>
+std::size_t probe(const std::unordered_map<K, V, Hash, Equal>& table, const std::vector<K>& keys)
+{
+    std::size_t sum{0};
+    for (auto& k : keys)
+        sum += table.find(k)->second;
+    return sum;
+}
+
+template<typename K, typename V, typename Hash, typename Equal>
+std::size_t probe(const OpenAddressingTable<K, V, Hash, Equal>& table, const std::vector<K>& keys)
+{
+    std::size_t sum{0};
+    for (auto& k : keys)
+        sum += *table.find(k);
+    return sum;
+}
+
+template<typename Table, typename K>
+void fill(Table& table, const std::vector<K>& keys)
+{
+    for (std::size_t i{0}; i < keys.size(); ++i)
+        table.insert({keys[i], i});
+}
+
+template<typename K, typename V, typename Hash, typename Equal>
+void fill(OpenAddressingTable<K, V, Hash, Equal>& table, const std::vector<K>& keys)
+{
+    for (std::size_t i{0}; i < keys.size(); ++i)
+        table.insert(keys[i], i);
+}
+
+//! The same records, as Bitfields, and as serialized values, which is what they usually are when they come from a wire.
+struct Records
+{
+    explicit Records(std::size_t count)
+    {
+        std::mt19937 generator{42};
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            serialized.push_back(static_cast<uint32_t>(generator()));
+            bitfields.emplace_back(serialized.back());
+        }
+    }
+
+    std::vector<Key> bitfields;
+    std::vector<uint32_t> serialized;
+};
+
+constexpr std::size_t number_of_keys{1 << 16};
+constexpr std::size_t open_addressing_capacity{4 * number_of_keys};
+
+TEST_CASE("Probing hash tables keyed with all the fields", "[!benchmark]")
+{
+    Records records{number_of_keys};
+
+    std::unordered_map<Key, std::size_t> unordered_map;
+    std::unordered_map<uint32_t, std::size_t, SerializedHash<Key>, SerializedEqual<Key>> unordered_map_serialized;
+    OpenAddressingTable<Key, std::size_t, BitfieldsHash<>, BitfieldsEqual<>> open_addressing{
+        open_addressing_capacity};
+    OpenAddressingTable<uint32_t, std::size_t, SerializedHash<Key>, SerializedEqual<Key>> open_addressing_serialized{
+        open_addressing_capacity};
+
+    fill(unordered_map, records.bitfields);
+    fill(unordered_map_serialized, records.serialized);
+    fill(open_addressing, records.bitfields);
+    fill(open_addressing_serialized, records.serialized);
+
+    BENCHMARK("std::unordered_map, keyed with Bitfields")
+    {
+        return probe(unordered_map, records.bitfields);
+    };
+
+    BENCHMARK("std::unordered_map, keyed with the serialized value")
+    {
+        return probe(unordered_map_serialized, records.serialized);
+    };
+
+    BENCHMARK("Open addressing, keyed with Bitfields")
+    {
+        return probe(open_addressing, records.bitfields);
+    };
+
+    BENCHMARK("Open addressing, keyed with the serialized value")
+    {
+        return probe(open_addressing_serialized, records.serialized);
+    };
+}
+
+//! A different workload than above: the records sharing the selected fields collapse into a single entry, thus the
+//! tables hold at most 2^11 entries, while being probed with the same number of records.
+TEST_CASE("Probing hash tables keyed with a subset of the fields", "[!benchmark]")
+{
+    Records records{number_of_keys};
+
+    using Hash = BitfieldsHash<Reg::field4, Reg::field6>;
+    using Equal = BitfieldsEqual<Reg::field4, Reg::field6>;
+    using SerializedHash = jungles::SerializedHash<Key, Reg::field4, Reg::field6>;
+    using SerializedEqual = jungles::SerializedEqual<Key, Reg::field4, Reg::field6>;
+
+    std::unordered_map<Key, std::size_t, Hash, Equal> unordered_map;
+    std::unordered_map<uint32_t, std::size_t, SerializedHash, SerializedEqual> unordered_map_serialized;
+    OpenAddressingTable<Key, std::size_t, Hash, Equal> open_addressing{open_addressing_capacity};
+    OpenAddressingTable<uint32_t, std::size_t, SerializedHash, SerializedEqual> open_addressing_serialized{
+        open_addressing_capacity};
+
+    fill(unordered_map, records.bitfields);
+    fill(unordered_map_serialized, records.serialized);
+    fill(open_addressing, records.bitfields);
+    fill(open_addressing_serialized, records.serialized);
+
+    BENCHMARK("std::unordered_map, keyed with a subset of Bitfields")
+    {
+        return probe(unordered_map, records.bitfields);
+    };
+
+    BENCHMARK("std::unordered_map, keyed with a subset of the serialized value")
+    {
+        return probe(unordered_map_serialized, records.serialized);
+    };
+
+    BENCHMARK("Open addressing, keyed with a subset of Bitfields")
+    {
+        return probe(open_addressing, records.bitfields);
+    };
+
+    BENCHMARK("Open addressing, keyed with a subset of the serialized value")
+    {
+        return probe(open_addressing_serialized, records.serialized);
+    };
+}
@@ -0,0 +1,157 @@
+/**
+ * @file        test_comparing_and_hashing.cpp
+ * @brief       Tests comparison and hashing of bitfields, e.g. to use them as keys of associative containers.
+ * @author      Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "jungles/bitfields.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+using Bf = Bitfields<uint16_t, Field<Reg::field1, 2>, Field<Reg::field2, 8>, Field<Reg::field3, 6>>;
+
+TEST_CASE("Bitfields are compared", "[comparison]")
+{
+    SECTION("Equal when all the fields are equal")
+    {
+        Bf bf1{0b1001101001101010}, bf2{0b1001101001101010};
+        REQUIRE(bf1 == bf2);
+        REQUIRE_FALSE(bf1 != bf2);
+    }
+
+    SECTION("Not equal when any of the fields differs")
+    {
+        Bf bf1{0b1001101001101010}, bf2{0b1001101001101011};
+        REQUIRE(bf1 != bf2);
+        REQUIRE_FALSE(bf1 == bf2);
+    }
+
+    SECTION("Overflown bits are not taken into account")
+    {
+        Bf bf1, bf2;
+        bf1.at<Reg::field2>() = 0x1FF;
+        bf2.at<Reg::field2>() = 0xFF;
+        REQUIRE(bf1 == bf2);
+    }
+
+    SECTION("Ordered by the serialized value")
+    {
+        Bf bf1{0b0111111111111111}, bf2{0b1000000000000000};
+        REQUIRE(bf1 < bf2);
+        REQUIRE_FALSE(bf2 < bf1);
+        REQUIRE_FALSE(bf1 < bf1);
+    }
+
+    SECTION("Compared at compile time")
+    {
+        static_assert(Bf{0b1001101001101010} == Bf{0b1001101001101010});
+        static_assert(Bf{0b1001101001101010} != Bf{0b0001101001101010});
+        static_assert(Bf{0b0001101001101010} < Bf{0b1001101001101010});
+    }
+
+    SECTION("Compared by a subset of the fields")
+    {
+        Bf bf1{0b1001101001101010}, bf2{0b1001101001010101};
+        REQUIRE(BitfieldsEqual<Reg::field1, Reg::field2>{}(bf1, bf2));
+        REQUIRE_FALSE(BitfieldsEqual<Reg::field2, Reg::field3>{}(bf1, bf2));
+        REQUIRE_FALSE(BitfieldsEqual<>{}(bf1, bf2));
+    }
+}
+
+TEST_CASE("Bitfields are hashed", "[hashing]")
+{
+    SECTION("Equal bitfields have equal hashes")
+    {
+        Bf bf1{0b1001101001101010}, bf2;
+        bf2.at<Reg::field1>() = 0b110;
+        bf2.at<Reg::field2>() = 0b01101001;
+        bf2.at<Reg::field3>() = 0b101010;
+        REQUIRE(std::hash<Bf>{}(bf1) == std::hash<Bf>{}(bf2));
+    }
+
+    SECTION("Hash depends on the selected fields only")
+    {
+        Bf bf1{0b1001101001101010}, bf2{0b1001101001010101};
+        using Hash = BitfieldsHash<Reg::field1, Reg::field2>;
+        REQUIRE(Hash{}(bf1) == Hash{}(bf2));
+    }
+
+    SECTION("Used as a key of std::unordered_map")
+    {
+        std::unordered_map<Bf, int> map;
+        map[Bf{0b1001101001101010}] = 1;
+        map[Bf{0b0110010110010101}] = 2;
+        map[Bf{0b1001101001101010}] += 10;
+
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.at(Bf{0b1001101001101010}) == 11);
+        REQUIRE(map.at(Bf{0b0110010110010101}) == 2);
+    }
+
+    SECTION("Used as a key of std::unordered_set, keyed on a subset of the fields")
+    {
+        std::unordered_set<Bf, BitfieldsHash<Reg::field2>, BitfieldsEqual<Reg::field2>> set;
+        set.insert(Bf{0b1001101001101010});
+        set.insert(Bf{0b0001101001010101});
+        set.insert(Bf{0b1000000000101010});
+
+        REQUIRE(set.size() == 2);
+        REQUIRE(set.count(Bf{0b0001101001000000}) == 1);
+    }
+
+    SECTION("Used as a key of std::map")
+    {
+        std::map<Bf, int> map{{Bf{0b1001101001101010}, 1}, {Bf{0b0110010110010101}, 2}};
+        REQUIRE(map.begin()->second == 2);
+    }
+}
+
+TEST_CASE("Serialized bitfields are hashed", "[hashing]")
+{
+    SECTION("Mask of the selected fields")
+    {
+        static_assert(Bf::mask<Reg::field2>() == 0b0011111111000000);
+        static_assert(Bf::mask<Reg::field1, Reg::field3>() == 0b1100000000111111);
+        static_assert(Bf::mask<>() == 0xFFFF);
+    }
+
+    SECTION("Compared by a subset of the fields")
+    {
+        uint16_t v1{0b1001101001101010}, v2{0b1001101001010101};
+        REQUIRE(SerializedEqual<Bf, Reg::field1, Reg::field2>{}(v1, v2));
+        REQUIRE_FALSE(SerializedEqual<Bf, Reg::field2, Reg::field3>{}(v1, v2));
+        REQUIRE_FALSE(SerializedEqual<Bf>{}(v1, v2));
+        REQUIRE(SerializedEqual<Bf>{}(v1, v1));
+    }
+
+    SECTION("Hash depends on the selected fields only")
+    {
+        uint16_t v1{0b1001101001101010}, v2{0b1001101001010101};
+        using Hash = SerializedHash<Bf, Reg::field1, Reg::field2>;
+        REQUIRE(Hash{}(v1) == Hash{}(v2));
+    }
+
+    SECTION("Hash is equal to the hash of the bitfields")
+    {
+        Bf bf{0b1001101001101010};
+        REQUIRE(SerializedHash<Bf>{}(bf.serialize()) == std::hash<Bf>{}(bf));
+        REQUIRE(SerializedHash<Bf, Reg::field3>{}(bf.serialize()) == BitfieldsHash<Reg::field3>{}(bf));
+    }
+
+    SECTION("Used as a key of std::unordered_set, keyed on a subset of the fields")
+    {
+        std::unordered_set<uint16_t, SerializedHash<Bf, Reg::field2>, SerializedEqual<Bf, Reg::field2>> set;
+        set.insert(0b1001101001101010);
+        set.insert(0b0001101001010101);
+        set.insert(0b1000000000101010);
+
+        REQUIRE(set.size() == 2);
+        REQUIRE(set.count(0b0001101001000000) == 1);
+    }
+}
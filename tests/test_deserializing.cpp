@@ -61,4 +61,22 @@ TEST_CASE("Fields are deserialized/loaded", "[desieralization]")
         REQUIRE(bf.extract<Reg::field2>() == 0b0000000111110000);
         REQUIRE(bf.extract<Reg::field3>() == 0b0000000000001111);
     }
+
+    SECTION("Single field is deserialized without loading the whole group")
+    {
+        using Bf = Bitfields<uint16_t, Field<Reg::field1, 5>, Field<Reg::field2, 7>, Field<Reg::field3, 4>>;
+
+        REQUIRE(Bf::deserialize<Reg::field1>(0b0010011000110110) == 0b00100);
+        REQUIRE(Bf::deserialize<Reg::field2>(0b0010011000110110) == 0b1100011);
+        REQUIRE(Bf::deserialize<Reg::field3>(0b0010011000110110) == 0b0110);
+    }
+
+    SECTION("Single field is deserialized at compile time")
+    {
+        using Bf = Bitfields<uint32_t, Field<Reg::field1, 17>, Field<Reg::field2, 1>, Field<Reg::field3, 14>>;
+
+        static_assert(Bf::deserialize<Reg::field1>(0b11111111111111111000000000000000) == 0b11111111111111111);
+        static_assert(Bf::deserialize<Reg::field2>(0b00000000000000000100000000000000) == 0b1);
+        static_assert(Bf::deserialize<Reg::field3>(0b00000000000000000111111111111111) == 0b11111111111111);
+    }
 }
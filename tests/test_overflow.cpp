@@ -4,6 +4,7 @@
  * @author      Kacper Kowalski - kacper.s.kowalski@gmail.com
  */
 #include <catch2/catch_test_macros.hpp>
+#include <unordered_set>
 
 #include "jungles/bitfields.hpp"
 
@@ -65,3 +66,168 @@ TEST_CASE("Overflows are not affecting other fields", "[overflow]")
         }
     }
 }
+
+struct SetLeastSignificantBit
+{
+    template<auto FieldId, typename T>
+    static constexpr T apply(T value, T mask) noexcept
+    {
+        return static_cast<T>((value & ~mask) != 0 ? 1 : value);
+    }
+};
+
+//! Misbehaving policy, which returns a value wider than the field.
+struct AllOnes
+{
+    template<auto FieldId, typename T>
+    static constexpr T apply(T value, T mask) noexcept
+    {
+        return static_cast<T>((value & ~mask) != 0 ? ~T{0} : value);
+    }
+};
+
+TEST_CASE("Overflow policies", "[overflow]")
+{
+    SECTION("Wrapping is the default policy")
+    {
+        REQUIRE(std::is_same_v<Bitfields<uint8_t, Field<Reg::field1, 3>, Field<Reg::field2, 5>>,
+                               BasicBitfields<overflow::Wrap, uint8_t, Field<Reg::field1, 3>, Field<Reg::field2, 5>>>);
+    }
+
+    SECTION("Saturating sets the maximum value of the field")
+    {
+        BasicBitfields<overflow::Saturate, uint16_t, Field<Reg::field1, 2>, Field<Reg::field2, 8>, Field<Reg::field3, 6>>
+            bf;
+
+        bf.at<Reg::field2>() = 0x1AB;
+        bf.at<Reg::field3>() = 0b101010;
+        REQUIRE(bf.serialize() == 0b0011111111101010);
+        REQUIRE(bf.at<Reg::field2>() == 0xFF);
+        REQUIRE(bf.at<Reg::field3>() == 0b101010);
+
+        bf.at<Reg::field3>() += 0b100000;
+        REQUIRE(bf.at<Reg::field3>() == 0b111111);
+    }
+
+    SECTION("Clearing zeroes the field")
+    {
+        BasicBitfields<overflow::Clear, uint16_t, Field<Reg::field1, 2>, Field<Reg::field2, 8>, Field<Reg::field3, 6>>
+            bf;
+
+        bf.at<Reg::field1>() = 0b11;
+        bf.at<Reg::field2>() = 0x1AB;
+        REQUIRE(bf.extract<Reg::field2>() == 0);
+        REQUIRE(bf.serialize() == 0b1100000000000000);
+        REQUIRE(bf.at<Reg::field2>() == 0);
+        REQUIRE(bf.at<Reg::field1>() == 0b11);
+    }
+
+    SECTION("Value returned by a user-defined policy never affects other fields")
+    {
+        BasicBitfields<AllOnes, uint8_t, Field<Reg::field1, 3>, Field<Reg::field2, 5>> bf;
+
+        bf.at<Reg::field2>() = 0b100000;
+        REQUIRE(bf.serialize() == 0b00011111);
+        REQUIRE(bf.at<Reg::field2>() == 0b11111);
+        REQUIRE(bf.at<Reg::field1>() == 0);
+    }
+
+    SECTION("User-defined policy")
+    {
+        BasicBitfields<SetLeastSignificantBit, uint8_t, Field<Reg::field1, 3>, Field<Reg::field2, 5>> bf;
+
+        bf.at<Reg::field1>() = 0b1000;
+        bf.at<Reg::field2>() = 0b10110;
+        REQUIRE(bf.serialize() == 0b00110110);
+    }
+
+    SECTION("Truncations are counted per field, when stored")
+    {
+        using Bf = BasicBitfields<overflow::Counting<overflow::Saturate>,
+                                  uint8_t,
+                                  Field<Reg::field1, 3>,
+                                  Field<Reg::field2, 5>>;
+        Bf::reset_truncations<Reg::field1>();
+        Bf::reset_truncations<Reg::field2>();
+
+        Bf bf;
+
+        bf.at<Reg::field1>() = 0b111;
+        bf.at<Reg::field2>() = 0b100000;
+        REQUIRE(bf.at<Reg::field1>() == 0b111);
+        REQUIRE(bf.at<Reg::field2>() == 0b11111);
+        REQUIRE(bf.at<Reg::field2>() == 0b11111);
+
+        bf.at<Reg::field2>() += 1;
+        REQUIRE(bf.at<Reg::field2>() == 0b11111);
+
+        REQUIRE(Bf::truncations<Reg::field1>() == 0);
+        REQUIRE(Bf::truncations<Reg::field2>() == 2);
+
+        Bf::reset_truncations<Reg::field2>();
+        REQUIRE(Bf::truncations<Reg::field2>() == 0);
+    }
+
+    SECTION("Truncation is counted once, when serialized, compared or hashed")
+    {
+        using Bf = BasicBitfields<overflow::Counting<>, uint8_t, Field<Reg::field1, 3>, Field<Reg::field2, 5>>;
+        Bf::reset_truncations<Reg::field2>();
+
+        Bf bf;
+        bf.at<Reg::field2>() = 40;
+
+        REQUIRE(bf.extract<Reg::field2>() == 0b01000);
+        REQUIRE(bf.serialize() == 0b01000);
+        REQUIRE(bf == Bf{0b01000});
+        REQUIRE_FALSE(bf < Bf{0b01000});
+        REQUIRE(std::hash<Bf>{}(bf) == std::hash<Bf>{}(Bf{0b01000}));
+        REQUIRE(BitfieldsEqual<Reg::field2>{}(bf, Bf{0b01000}));
+
+        std::unordered_set<Bf> set;
+        set.insert(bf);
+        REQUIRE(set.count(bf) == 1);
+        REQUIRE(set.count(Bf{0b01000}) == 1);
+        REQUIRE(bf.at<Reg::field2>() == 0b01000);
+
+        REQUIRE(Bf::truncations<Reg::field2>() == 1);
+    }
+
+    SECTION("Each overflowing write is counted, when followed by serialization only")
+    {
+        using Bf = BasicBitfields<overflow::Counting<overflow::Saturate>,
+                                  uint8_t,
+                                  Field<Reg::field1, 3>,
+                                  Field<Reg::field2, 5>>;
+        Bf::reset_truncations<Reg::field2>();
+
+        Bf bf;
+        bf.at<Reg::field2>() = 200;
+        REQUIRE(bf.serialize() == 0b00011111);
+        REQUIRE(Bf::truncations<Reg::field2>() == 1);
+
+        for (unsigned i{0}; i < 1000; ++i)
+        {
+            bf.at<Reg::field2>() = 200;
+            bf.serialize();
+        }
+        REQUIRE(Bf::truncations<Reg::field2>() == 1001);
+    }
+
+    SECTION("Bitfield groups have separate counters, even if the field IDs are the same")
+    {
+        using Bf1 = BasicBitfields<overflow::Counting<>, uint8_t, Field<Reg::field1, 4>, Field<Reg::field2, 4>>;
+        using Bf2 = BasicBitfields<overflow::Counting<>, uint8_t, Field<Reg::field1, 2>, Field<Reg::field2, 6>>;
+        Bf1::reset_truncations<Reg::field1>();
+        Bf2::reset_truncations<Reg::field1>();
+
+        Bf1 bf1;
+        Bf2 bf2;
+        bf1.at<Reg::field1>() = 0b1111;
+        bf2.at<Reg::field1>() = 0b1111;
+        REQUIRE(bf1.at<Reg::field1>() == 0b1111);
+        REQUIRE(bf2.at<Reg::field1>() == 0b11);
+
+        REQUIRE(Bf1::truncations<Reg::field1>() == 0);
+        REQUIRE(Bf2::truncations<Reg::field1>() == 1);
+    }
+}
@@ -47,6 +47,15 @@ TEST_CASE("Two-byte-long bitfield group is serialized", "[serializing]")
 
         REQUIRE(bf.serialize() == 0b1000001111001100);
     }
+
+    SECTION("Only the selected fields")
+    {
+        Bitfields<uint16_t, Field<Reg::field1, 2>, Field<Reg::field2, 8>, Field<Reg::field3, 6>> bf{0b1001101001101010};
+
+        REQUIRE(bf.serialize<Reg::field2>() == 0b0001101001000000);
+        REQUIRE(bf.serialize<Reg::field1, Reg::field3>() == 0b1000000000101010);
+        REQUIRE(bf.serialize<Reg::field1, Reg::field2, Reg::field3>() == bf.serialize());
+    }
 }
 
 TEST_CASE("Four-byte-long bitfield group is serialized", "[serializing]")